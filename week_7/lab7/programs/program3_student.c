@@ -1,16 +1,27 @@
 /*
  * Program 3: Student Grade Management System
  * Description: Manages student grades with statistics calculation,
- * grade assignment, sorting, and reporting features.
- * Lines of Code: ~280
+ * grade assignment, sorting, and reporting features. Records live in a
+ * growable chunked store with no fixed student limit, indexed by id
+ * with a hash table for constant-time search, update and delete, and
+ * sorted by average with a radix sort over (key, index) pairs. Top
+ * performers come from a bounded heap (threaded for large stores)
+ * without reordering the records.
+ * Lines of Code: ~960
+ * Build: gcc program3_student.c -pthread
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
 
-#define MAX_STUDENTS 50
+#define STUDENT_CHUNK 1024
+#define INDEX_MIN_CAPACITY 64
 #define MAX_NAME 50
 #define MAX_SUBJECTS 5
+#define TOPK_THREADS 4
+#define TOPK_PARALLEL_MIN 65536
 
 // Student structure
 struct Student {
@@ -21,11 +32,242 @@ struct Student {
     char grade;
 };
 
+// Slot of the id hash index (slot -1 means empty)
+struct IndexEntry {
+    int id;
+    int slot;
+    int distance;
+};
+
+// Candidate in a top-K heap
+struct RankEntry {
+    float average;
+    int slot;
+};
+
+// Work for one top-K thread: a range of records and its own heap
+struct TopKTask {
+    int start;
+    int end;
+    int k;
+    struct RankEntry *heap;
+    int size;
+};
+
 // Global variables
-struct Student students[MAX_STUDENTS];
+// Students are stored in fixed-size chunks reached through a chunk
+// directory. Growing only reallocates the directory of pointers, so
+// records never move and pointers to them stay valid.
+struct Student **student_chunks = NULL;
+int chunk_count = 0;
+int chunk_capacity = 0;
 int student_count = 0;
 int num_subjects = 3;
 
+// Open-addressing (Robin Hood) hash index from student id to record index
+struct IndexEntry *id_index = NULL;
+int index_capacity = 0;
+int index_size = 0;
+
+// Function to get student record by index
+struct Student *get_student(int index) {
+    return &student_chunks[index / STUDENT_CHUNK][index % STUDENT_CHUNK];
+}
+
+// Function to reserve the record slot after the last student.
+// Returns NULL if memory runs out; the caller fills the slot and then
+// increments student_count.
+struct Student *append_student_slot() {
+    struct Student **directory = NULL;
+    int capacity = 0;
+    
+    if (student_count == chunk_count * STUDENT_CHUNK) {
+        if (chunk_count == chunk_capacity) {
+            capacity = chunk_capacity == 0 ? 16 : chunk_capacity * 2;
+            directory = realloc(student_chunks, sizeof(struct Student *) * capacity);
+            if (directory == NULL) {
+                return NULL;
+            }
+            student_chunks = directory;
+            chunk_capacity = capacity;
+        }
+        
+        student_chunks[chunk_count] = malloc(sizeof(struct Student) * STUDENT_CHUNK);
+        if (student_chunks[chunk_count] == NULL) {
+            return NULL;
+        }
+        chunk_count = chunk_count + 1;
+    }
+    
+    return get_student(student_count);
+}
+
+// Function to release all student storage
+void free_student_store() {
+    int i = 0;
+    
+    i = 0;
+    while (i < chunk_count) {
+        free(student_chunks[i]);
+        i = i + 1;
+    }
+    free(student_chunks);
+    student_chunks = NULL;
+    free(id_index);
+    id_index = NULL;
+    index_capacity = 0;
+    index_size = 0;
+    chunk_count = 0;
+    chunk_capacity = 0;
+    student_count = 0;
+}
+
+// Function to get the home bucket of an id (capacity is a power of two)
+int index_home(int id) {
+    unsigned int hash = 0;
+    
+    hash = (unsigned int)id * 2654435769u;
+    hash = hash ^ (hash >> 16);
+    return (int)(hash & (unsigned int)(index_capacity - 1));
+}
+
+// Function to find the bucket holding an id, or -1.
+// Robin Hood order lets the probe stop as soon as it passes an entry
+// that is closer to its home than the probe is to the id's home.
+int index_bucket(int id) {
+    int bucket = 0;
+    int distance = 0;
+    
+    if (index_capacity == 0) {
+        return -1;
+    }
+    
+    bucket = index_home(id);
+    distance = 0;
+    while (id_index[bucket].slot != -1 && id_index[bucket].distance >= distance) {
+        if (id_index[bucket].id == id) {
+            return bucket;
+        }
+        bucket = (bucket + 1) & (index_capacity - 1);
+        distance = distance + 1;
+    }
+    
+    return -1;
+}
+
+// Function to find the record index of a student id, or -1
+int index_find(int id) {
+    int bucket = 0;
+    
+    bucket = index_bucket(id);
+    return bucket < 0 ? -1 : id_index[bucket].slot;
+}
+
+// Function to insert an id that is not yet indexed.
+// An entry farther from home takes the bucket of a richer entry, which
+// then continues probing, keeping probe lengths short and even.
+void index_place(int id, int slot) {
+    struct IndexEntry entry;
+    struct IndexEntry swap;
+    int bucket = 0;
+    
+    entry.id = id;
+    entry.slot = slot;
+    entry.distance = 0;
+    bucket = index_home(id);
+    
+    while (id_index[bucket].slot != -1) {
+        if (id_index[bucket].distance < entry.distance) {
+            swap = id_index[bucket];
+            id_index[bucket] = entry;
+            entry = swap;
+        }
+        bucket = (bucket + 1) & (index_capacity - 1);
+        entry.distance = entry.distance + 1;
+    }
+    
+    id_index[bucket] = entry;
+    index_size = index_size + 1;
+}
+
+// Function to rebuild the index from the store with the given capacity
+int index_rebuild(int capacity) {
+    struct IndexEntry *table = NULL;
+    int i = 0;
+    
+    // Rebuilding at the same capacity reuses the table and cannot fail
+    if (capacity != index_capacity) {
+        table = malloc(sizeof(struct IndexEntry) * capacity);
+        if (table == NULL) {
+            return 0;
+        }
+        free(id_index);
+        id_index = table;
+        index_capacity = capacity;
+    }
+    index_size = 0;
+    
+    i = 0;
+    while (i < capacity) {
+        id_index[i].slot = -1;
+        i = i + 1;
+    }
+    
+    i = 0;
+    while (i < student_count) {
+        index_place(get_student(i)->id, i);
+        i = i + 1;
+    }
+    
+    return 1;
+}
+
+// Function to index a new id, doubling the table above 3/4 load
+int index_insert(int id, int slot) {
+    int capacity = 0;
+    
+    if ((index_size + 1) * 4 > index_capacity * 3) {
+        capacity = index_capacity == 0 ? INDEX_MIN_CAPACITY : index_capacity * 2;
+        if (index_rebuild(capacity) == 0) {
+            return 0;
+        }
+    }
+    
+    index_place(id, slot);
+    return 1;
+}
+
+// Function to point an indexed id at a new record index
+void index_move(int id, int slot) {
+    int bucket = 0;
+    
+    bucket = index_bucket(id);
+    if (bucket >= 0) {
+        id_index[bucket].slot = slot;
+    }
+}
+
+// Function to remove an id, shifting later entries of the run back
+void index_remove(int id) {
+    int bucket = 0;
+    int next = 0;
+    
+    bucket = index_bucket(id);
+    if (bucket < 0) {
+        return;
+    }
+    
+    next = (bucket + 1) & (index_capacity - 1);
+    while (id_index[next].slot != -1 && id_index[next].distance > 0) {
+        id_index[bucket] = id_index[next];
+        id_index[bucket].distance = id_index[bucket].distance - 1;
+        bucket = next;
+        next = (next + 1) & (index_capacity - 1);
+    }
+    id_index[bucket].slot = -1;
+    index_size = index_size - 1;
+}
+
 // Function to calculate average
 float calculate_average(int marks[], int count) {
     int sum = 0;
@@ -70,16 +312,17 @@ void add_student() {
     int marks[MAX_SUBJECTS];
     float avg = 0.0;
     char grade = 'F';
-    
-    if (student_count >= MAX_STUDENTS) {
-        printf("Maximum student limit reached!\n");
-        return;
-    }
+    struct Student *student = NULL;
     
     printf("\nEnter student ID: ");
     scanf("%d", &id);
     getchar();
     
+    if (index_find(id) >= 0) {
+        printf("Student ID %d already exists!\n", id);
+        return;
+    }
+    
     printf("Enter student name: ");
     fgets(name, MAX_NAME, stdin);
     name[strcspn(name, "\n")] = 0;
@@ -97,15 +340,20 @@ void add_student() {
     grade = assign_grade(avg);
     
     // Store student data
-    students[student_count].id = id;
-    strcpy(students[student_count].name, name);
+    student = append_student_slot();
+    if (student == NULL || index_insert(id, student_count) == 0) {
+        printf("Out of memory, student not added!\n");
+        return;
+    }
+    student->id = id;
+    strcpy(student->name, name);
     i = 0;
     while (i < num_subjects) {
-        students[student_count].marks[i] = marks[i];
+        student->marks[i] = marks[i];
         i = i + 1;
     }
-    students[student_count].average = avg;
-    students[student_count].grade = grade;
+    student->average = avg;
+    student->grade = grade;
     
     student_count = student_count + 1;
     printf("Student added successfully!\n");
@@ -125,18 +373,18 @@ void display_students() {
     i = 0;
     while (i < student_count) {
         printf("\nStudent %d:\n", i + 1);
-        printf("ID: %d\n", students[i].id);
-        printf("Name: %s\n", students[i].name);
+        printf("ID: %d\n", get_student(i)->id);
+        printf("Name: %s\n", get_student(i)->name);
         printf("Marks: ");
         
         j = 0;
         while (j < num_subjects) {
-            printf("%d ", students[i].marks[j]);
+            printf("%d ", get_student(i)->marks[j]);
             j = j + 1;
         }
         
-        printf("\nAverage: %.2f\n", students[i].average);
-        printf("Grade: %c\n", students[i].grade);
+        printf("\nAverage: %.2f\n", get_student(i)->average);
+        printf("Grade: %c\n", get_student(i)->grade);
         i = i + 1;
     }
 }
@@ -145,35 +393,27 @@ void display_students() {
 void search_student() {
     int search_id = 0;
     int i = 0;
-    int found = 0;
     int j = 0;
     
     printf("\nEnter student ID to search: ");
     scanf("%d", &search_id);
     
-    found = 0;
-    i = 0;
-    while (i < student_count && found == 0) {
-        if (students[i].id == search_id) {
-            found = 1;
-            printf("\nStudent Found:\n");
-            printf("ID: %d\n", students[i].id);
-            printf("Name: %s\n", students[i].name);
-            printf("Marks: ");
-            
-            j = 0;
-            while (j < num_subjects) {
-                printf("%d ", students[i].marks[j]);
-                j = j + 1;
-            }
-            
-            printf("\nAverage: %.2f\n", students[i].average);
-            printf("Grade: %c\n", students[i].grade);
+    i = index_find(search_id);
+    if (i >= 0) {
+        printf("\nStudent Found:\n");
+        printf("ID: %d\n", get_student(i)->id);
+        printf("Name: %s\n", get_student(i)->name);
+        printf("Marks: ");
+        
+        j = 0;
+        while (j < num_subjects) {
+            printf("%d ", get_student(i)->marks[j]);
+            j = j + 1;
         }
-        i = i + 1;
-    }
-    
-    if (found == 0) {
+        
+        printf("\nAverage: %.2f\n", get_student(i)->average);
+        printf("Grade: %c\n", get_student(i)->grade);
+    } else {
         printf("Student not found!\n");
     }
 }
@@ -194,24 +434,24 @@ void calculate_statistics() {
     }
     
     sum = 0.0;
-    highest = students[0].average;
-    lowest = students[0].average;
+    highest = get_student(0)->average;
+    lowest = get_student(0)->average;
     pass_count = 0;
     fail_count = 0;
     
     i = 0;
     while (i < student_count) {
-        sum = sum + students[i].average;
+        sum = sum + get_student(i)->average;
         
-        if (students[i].average > highest) {
-            highest = students[i].average;
+        if (get_student(i)->average > highest) {
+            highest = get_student(i)->average;
         }
         
-        if (students[i].average < lowest) {
-            lowest = students[i].average;
+        if (get_student(i)->average < lowest) {
+            lowest = get_student(i)->average;
         }
         
-        if (students[i].average >= 60.0) {
+        if (get_student(i)->average >= 60.0) {
             pass_count = pass_count + 1;
         } else {
             fail_count = fail_count + 1;
@@ -231,45 +471,309 @@ void calculate_statistics() {
     printf("Fail Count: %d\n", fail_count);
 }
 
-// Function to sort students by average
+// Function to map a float to an unsigned key with the same ordering.
+// Positive floats get the sign bit set; negative floats are inverted so
+// larger magnitudes sort lower.
+unsigned int float_sort_key(float value) {
+    unsigned int bits = 0;
+    
+    memcpy(&bits, &value, sizeof(bits));
+    if (bits & 0x80000000u) {
+        return ~bits;
+    }
+    return bits | 0x80000000u;
+}
+
+// Function to sort students by average (descending, ties keep their order).
+// Only (key, index) pairs are sorted, with a 4-pass LSD radix sort on
+// inverted float keys; each record is then moved once by following the
+// cycles of the permutation.
 void sort_students() {
+    unsigned int *keys = NULL;
+    unsigned int *key_buffer = NULL;
+    int *order = NULL;
+    int *order_buffer = NULL;
+    unsigned int *swap_keys = NULL;
+    int *swap_order = NULL;
+    int count[256];
     int i = 0;
-    int j = 0;
+    int pass = 0;
+    int shift = 0;
+    int digit = 0;
+    int total = 0;
+    int start = 0;
+    int current = 0;
+    int next = 0;
     struct Student temp;
-    int swapped = 0;
     
     if (student_count == 0) {
         printf("\nNo students to sort.\n");
         return;
     }
     
-    // Bubble sort
+    keys = malloc(sizeof(unsigned int) * student_count);
+    key_buffer = malloc(sizeof(unsigned int) * student_count);
+    order = malloc(sizeof(int) * student_count);
+    order_buffer = malloc(sizeof(int) * student_count);
+    if (keys == NULL || key_buffer == NULL || order == NULL || order_buffer == NULL) {
+        printf("Out of memory, students not sorted!\n");
+        free(keys);
+        free(key_buffer);
+        free(order);
+        free(order_buffer);
+        return;
+    }
+    
+    // Inverted keys make an ascending radix sort produce descending averages
     i = 0;
-    while (i < student_count - 1) {
-        swapped = 0;
-        j = 0;
-        while (j < student_count - i - 1) {
-            if (students[j].average < students[j + 1].average) {
-                temp = students[j];
-                students[j] = students[j + 1];
-                students[j + 1] = temp;
-                swapped = 1;
-            }
-            j = j + 1;
+    while (i < student_count) {
+        keys[i] = ~float_sort_key(get_student(i)->average);
+        order[i] = i;
+        i = i + 1;
+    }
+    
+    pass = 0;
+    while (pass < 4) {
+        shift = pass * 8;
+        memset(count, 0, sizeof(count));
+        
+        i = 0;
+        while (i < student_count) {
+            count[(keys[i] >> shift) & 0xFF] = count[(keys[i] >> shift) & 0xFF] + 1;
+            i = i + 1;
         }
         
-        if (swapped == 0) {
-            break;
+        total = 0;
+        digit = 0;
+        while (digit < 256) {
+            next = count[digit];
+            count[digit] = total;
+            total = total + next;
+            digit = digit + 1;
         }
         
-        i = i + 1;
+        i = 0;
+        while (i < student_count) {
+            digit = (keys[i] >> shift) & 0xFF;
+            key_buffer[count[digit]] = keys[i];
+            order_buffer[count[digit]] = order[i];
+            count[digit] = count[digit] + 1;
+            i = i + 1;
+        }
+        
+        swap_keys = keys;
+        keys = key_buffer;
+        key_buffer = swap_keys;
+        swap_order = order;
+        order = order_buffer;
+        order_buffer = swap_order;
+        pass = pass + 1;
+    }
+    
+    // order[i] is the record that belongs at position i; walk each cycle
+    // once, marking visited positions with -1
+    start = 0;
+    while (start < student_count) {
+        if (order[start] != -1 && order[start] != start) {
+            temp = *get_student(start);
+            current = start;
+            next = order[current];
+            while (next != start) {
+                *get_student(current) = *get_student(next);
+                order[current] = -1;
+                current = next;
+                next = order[current];
+            }
+            *get_student(current) = temp;
+            order[current] = -1;
+        }
+        start = start + 1;
     }
     
+    free(keys);
+    free(key_buffer);
+    free(order);
+    free(order_buffer);
+    
+    // Every record may have moved, so rebuild the id index in one pass
+    index_rebuild(index_capacity);
+    
     printf("Students sorted by average (descending order).\n");
 }
 
+// Function to check whether one candidate ranks above another.
+// Ties go to the earlier record, matching the stable sort order.
+int rank_before(struct RankEntry a, struct RankEntry b) {
+    if (a.average != b.average) {
+        return a.average > b.average;
+    }
+    return a.slot < b.slot;
+}
+
+// Function to restore the heap below a position (weakest entry on top)
+void rank_sift_down(struct RankEntry *heap, int size, int pos) {
+    struct RankEntry temp;
+    int child = 0;
+    
+    while (pos * 2 + 1 < size) {
+        child = pos * 2 + 1;
+        if (child + 1 < size && rank_before(heap[child], heap[child + 1])) {
+            child = child + 1;
+        }
+        if (!rank_before(heap[pos], heap[child])) {
+            break;
+        }
+        temp = heap[pos];
+        heap[pos] = heap[child];
+        heap[child] = temp;
+        pos = child;
+    }
+}
+
+// Function to offer a candidate to a heap bounded at k entries.
+// Returns the new heap size.
+int rank_offer(struct RankEntry *heap, int size, int k, struct RankEntry entry) {
+    struct RankEntry temp;
+    int pos = 0;
+    int parent = 0;
+    
+    if (size < k) {
+        heap[size] = entry;
+        pos = size;
+        while (pos > 0) {
+            parent = (pos - 1) / 2;
+            if (!rank_before(heap[parent], heap[pos])) {
+                break;
+            }
+            temp = heap[pos];
+            heap[pos] = heap[parent];
+            heap[parent] = temp;
+            pos = parent;
+        }
+        return size + 1;
+    }
+    
+    // Full: replace the weakest entry only if the candidate beats it
+    if (rank_before(entry, heap[0])) {
+        heap[0] = entry;
+        rank_sift_down(heap, size, 0);
+    }
+    return size;
+}
+
+// Function to collect the top k of a range of records into a task's heap
+void *collect_top_range(void *arg) {
+    struct TopKTask *task = (struct TopKTask *)arg;
+    struct RankEntry entry;
+    int i = 0;
+    
+    task->size = 0;
+    i = task->start;
+    while (i < task->end) {
+        entry.average = get_student(i)->average;
+        entry.slot = i;
+        task->size = rank_offer(task->heap, task->size, task->k, entry);
+        i = i + 1;
+    }
+    
+    return NULL;
+}
+
+// Function to find the k best records by average without reordering them.
+// Fills ranking best-first and returns how many entries it holds.
+// Large stores are split across threads, each keeping its own heap of k,
+// and the per-thread heaps are merged into the final one.
+int find_top_k(int k, struct RankEntry *ranking) {
+    struct TopKTask tasks[TOPK_THREADS];
+    pthread_t threads[TOPK_THREADS];
+    int started[TOPK_THREADS];
+    struct RankEntry entry;
+    struct RankEntry temp;
+    int thread_count = 1;
+    int size = 0;
+    int t = 0;
+    int i = 0;
+    
+    if (k > student_count) {
+        k = student_count;
+    }
+    if (k <= 0) {
+        return 0;
+    }
+    
+    if (student_count >= TOPK_PARALLEL_MIN) {
+        thread_count = TOPK_THREADS;
+    }
+    
+    t = 0;
+    while (t < thread_count) {
+        tasks[t].start = (int)((long)student_count * t / thread_count);
+        tasks[t].end = (int)((long)student_count * (t + 1) / thread_count);
+        tasks[t].k = k;
+        tasks[t].size = 0;
+        tasks[t].heap = NULL;
+        started[t] = 0;
+        if (thread_count > 1) {
+            tasks[t].heap = malloc(sizeof(struct RankEntry) * k);
+        }
+        t = t + 1;
+    }
+    
+    if (thread_count == 1) {
+        tasks[0].heap = ranking;
+        collect_top_range(&tasks[0]);
+        size = tasks[0].size;
+    } else {
+        t = 0;
+        while (t < thread_count) {
+            if (tasks[t].heap != NULL &&
+                pthread_create(&threads[t], NULL, collect_top_range, &tasks[t]) == 0) {
+                started[t] = 1;
+            }
+            t = t + 1;
+        }
+        
+        // Ranges whose thread could not start are scanned here instead
+        size = 0;
+        t = 0;
+        while (t < thread_count) {
+            if (started[t] == 1) {
+                pthread_join(threads[t], NULL);
+                i = 0;
+                while (i < tasks[t].size) {
+                    size = rank_offer(ranking, size, k, tasks[t].heap[i]);
+                    i = i + 1;
+                }
+            } else {
+                i = tasks[t].start;
+                while (i < tasks[t].end) {
+                    entry.average = get_student(i)->average;
+                    entry.slot = i;
+                    size = rank_offer(ranking, size, k, entry);
+                    i = i + 1;
+                }
+            }
+            free(tasks[t].heap);
+            t = t + 1;
+        }
+    }
+    
+    // Heap sort in place: repeatedly move the weakest entry to the end
+    i = size - 1;
+    while (i > 0) {
+        temp = ranking[0];
+        ranking[0] = ranking[i];
+        ranking[i] = temp;
+        rank_sift_down(ranking, i, 0);
+        i = i - 1;
+    }
+    
+    return size;
+}
+
 // Function to display top performers
 void display_top_performers() {
+    struct RankEntry *ranking = NULL;
     int i = 0;
     int count = 0;
     int display_count = 5;
@@ -279,23 +783,38 @@ void display_top_performers() {
         return;
     }
     
-    // First sort students
-    sort_students();
-    
-    printf("\n=== Top Performers ===\n");
+    printf("\nEnter number of top performers to display: ");
+    scanf("%d", &display_count);
+    if (display_count <= 0) {
+        printf("Invalid count!\n");
+        return;
+    }
+    if (display_count > student_count) {
+        display_count = student_count;
+    }
     
-    count = student_count;
-    if (count > display_count) {
-        count = display_count;
+    ranking = malloc(sizeof(struct RankEntry) * display_count);
+    if (ranking == NULL) {
+        printf("Out of memory!\n");
+        return;
     }
     
+    // Records stay in place; only the k best (average, index) pairs are kept
+    count = find_top_k(display_count, ranking);
+    
+    printf("\n=== Top Performers ===\n");
+    
     i = 0;
     while (i < count) {
         printf("%d. %s (ID: %d) - Average: %.2f, Grade: %c\n",
-               i + 1, students[i].name, students[i].id,
-               students[i].average, students[i].grade);
+               i + 1, get_student(ranking[i].slot)->name,
+               get_student(ranking[i].slot)->id,
+               get_student(ranking[i].slot)->average,
+               get_student(ranking[i].slot)->grade);
         i = i + 1;
     }
+    
+    free(ranking);
 }
 
 // Function to update student marks
@@ -303,7 +822,6 @@ void update_student() {
     int search_id = 0;
     int i = 0;
     int j = 0;
-    int found = 0;
     int marks[MAX_SUBJECTS];
     float avg = 0.0;
     char grade = 'F';
@@ -311,41 +829,62 @@ void update_student() {
     printf("\nEnter student ID to update: ");
     scanf("%d", &search_id);
     
-    found = 0;
-    i = 0;
-    while (i < student_count && found == 0) {
-        if (students[i].id == search_id) {
-            found = 1;
-            printf("Current marks: ");
-            j = 0;
-            while (j < num_subjects) {
-                printf("%d ", students[i].marks[j]);
-                j = j + 1;
-            }
-            printf("\n");
-            
-            printf("Enter new marks for %d subjects:\n", num_subjects);
-            j = 0;
-            while (j < num_subjects) {
-                printf("Subject %d: ", j + 1);
-                scanf("%d", &marks[j]);
-                students[i].marks[j] = marks[j];
-                j = j + 1;
-            }
-            
-            avg = calculate_average(students[i].marks, num_subjects);
-            grade = assign_grade(avg);
-            students[i].average = avg;
-            students[i].grade = grade;
-            
-            printf("Student marks updated successfully!\n");
+    // Marks change but the id does not, so the index entry stays valid
+    i = index_find(search_id);
+    if (i >= 0) {
+        printf("Current marks: ");
+        j = 0;
+        while (j < num_subjects) {
+            printf("%d ", get_student(i)->marks[j]);
+            j = j + 1;
         }
-        i = i + 1;
+        printf("\n");
+        
+        printf("Enter new marks for %d subjects:\n", num_subjects);
+        j = 0;
+        while (j < num_subjects) {
+            printf("Subject %d: ", j + 1);
+            scanf("%d", &marks[j]);
+            get_student(i)->marks[j] = marks[j];
+            j = j + 1;
+        }
+        
+        avg = calculate_average(get_student(i)->marks, num_subjects);
+        grade = assign_grade(avg);
+        get_student(i)->average = avg;
+        get_student(i)->grade = grade;
+        
+        printf("Student marks updated successfully!\n");
+    } else {
+        printf("Student not found!\n");
     }
+}
+
+// Function to delete student by ID.
+// The last record is moved into the freed position (O(1), no shifting),
+// so the order of the remaining records may change.
+void delete_student() {
+    int search_id = 0;
+    int i = 0;
+    int last = 0;
+    
+    printf("\nEnter student ID to delete: ");
+    scanf("%d", &search_id);
     
-    if (found == 0) {
+    i = index_find(search_id);
+    if (i < 0) {
         printf("Student not found!\n");
+        return;
+    }
+    
+    index_remove(search_id);
+    last = student_count - 1;
+    if (i != last) {
+        *get_student(i) = *get_student(last);
+        index_move(get_student(i)->id, i);
     }
+    student_count = student_count - 1;
+    printf("Student deleted successfully!\n");
 }
 
 // Main function
@@ -366,6 +905,7 @@ int main() {
         printf("5. Sort Students by Average\n");
         printf("6. Display Top Performers\n");
         printf("7. Update Student Marks\n");
+        printf("8. Delete Student\n");
         printf("0. Exit\n");
         printf("Enter choice: ");
         scanf("%d", &choice);
@@ -389,8 +929,11 @@ int main() {
             display_top_performers();
         } else if (choice == 7) {
             update_student();
+        } else if (choice == 8) {
+            delete_student();
         } else if (choice == 0) {
             continue_flag = 0;
+            free_student_store();
             printf("Exiting system. Thank you!\n");
         } else {
             printf("Invalid choice! Please try again.\n");